@@ -2,10 +2,37 @@
 #include <stdlib.h>
 #include <string.h>
 #include <limits.h>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <process.h>
+#define getpid _getpid
+#endif
 
-#define MAX_NODES 300
+#ifndef MAX_NODES
+#define MAX_NODES 300  // Capacity of the graph arrays; larger test graphs may override it
+#endif
+#define MAP_NODES 300  // Node ids used by the hardcoded delivery map
+#if MAP_NODES > MAX_NODES
+#error "MAX_NODES must be at least MAP_NODES"
+#endif
 #define MAX_PRODUCTS 100
 #define INF 100000  // Large value to represent no direct path
+#define WAREHOUSE_NODE 0  // Node where every delivery route starts and ends
+#define MINPLUS_BLOCK 64  // Tile size of the blocked min-plus (Floyd-Warshall) kernel
+#define SNAPSHOT_FILE "routing.snap"  // Precomputed routing tables, kept next to the executable
+#define SNAPSHOT_ENV "ROUTING_SNAPSHOT"  // Overrides the snapshot path; an empty value disables it
+#define SNAPSHOT_MAGIC "SCPSNAP"
+#define SNAPSHOT_VERSION 3
+#define SNAPSHOT_BYTE_ORDER 0x01020304u  // Reads back differently on a machine of the other byte order
+#define FNV_OFFSET 14695981039346656037ULL
+#define FNV_PRIME 1099511628211ULL
 
 typedef struct {
     char name[50];
@@ -27,6 +54,7 @@ typedef struct ListNode {
 typedef struct {
     int numNodes;
     ListNode* adjList[MAX_NODES];
+    int component[MAX_NODES];  // Connected component label of each node
 } Graph;
 
 // Priority queue node for Dijkstra's algorithm
@@ -40,6 +68,27 @@ typedef struct {
     int size;
 } MinHeap;
 
+// Header at the start of a routing snapshot file, followed by the dist and pred tables
+typedef struct {
+    char magic[8];
+    unsigned int version;
+    unsigned int byteOrder;              // SNAPSHOT_BYTE_ORDER as stored by the writing machine
+    unsigned int intSize;                // sizeof(int) on the writing machine
+    unsigned int numNodes;
+    unsigned long long graphHash;        // Fingerprint of the graph the tables were built from
+    unsigned long long payloadSize;
+    unsigned long long payloadChecksum;  // checksumWords() of the dist and pred tables
+} SnapshotHeader;
+
+// All-pairs routing tables, either mapped from a snapshot or built at startup
+typedef struct {
+    int numNodes;
+    const int* dist;  // dist[s * numNodes + v]: shortest distance from s to v
+    const int* pred;  // pred[s * numNodes + v]: node before v on the path from s, -1 if none
+} RoutingTables;
+
+RoutingTables routing = {0, NULL, NULL};
+
 // Function to create a new adjacency list node
 void addEdge(Graph* graph, int u, int v, int weight) {
     ListNode* newNode = (ListNode*)malloc(sizeof(ListNode));
@@ -55,6 +104,44 @@ void addEdge(Graph* graph, int u, int v, int weight) {
     graph->adjList[v] = newNode;
 }
 
+// Label connected components with a BFS so reachability checks are O(1)
+void labelComponents(Graph* graph) {
+    int queue[MAX_NODES];
+    int label = 0;
+
+    for (int i = 0; i < graph->numNodes; i++) {
+        graph->component[i] = -1;
+    }
+
+    for (int s = 0; s < graph->numNodes; s++) {
+        if (graph->component[s] != -1) {
+            continue;
+        }
+
+        int head = 0, tail = 0;
+        queue[tail++] = s;
+        graph->component[s] = label;
+
+        while (head < tail) {
+            int u = queue[head++];
+            ListNode* temp = graph->adjList[u];
+            while (temp != NULL) {
+                if (graph->component[temp->vertex] == -1) {
+                    graph->component[temp->vertex] = label;
+                    queue[tail++] = temp->vertex;
+                }
+                temp = temp->next;
+            }
+        }
+        label++;
+    }
+}
+
+// Function to check if two nodes lie in the same connected component
+int isReachable(Graph* graph, int u, int v) {
+    return graph->component[u] == graph->component[v];
+}
+
 // Function to create a new min heap node for Dijkstra
 MinHeapNode* newMinHeapNode(int vertex, int distance) {
     MinHeapNode* minHeapNode = (MinHeapNode*)malloc(sizeof(MinHeapNode));
@@ -148,9 +235,8 @@ void printPath(int parent[], int target) {
     printf("-> %d ", target);
 }
 
-// Dijkstra's Algorithm to find the shortest path between two nodes, storing the path
-int dijkstra(Graph* graph, int src, int target, int parent[]) {
-    int dist[MAX_NODES];
+// Dijkstra's Algorithm from src, storing the distance and parent of every node
+void dijkstraAll(Graph* graph, int src, int dist[], int parent[]) {
     MinHeap* minHeap = createMinHeap();
 
     for (int i = 0; i < graph->numNodes; i++) {
@@ -166,6 +252,7 @@ int dijkstra(Graph* graph, int src, int target, int parent[]) {
     while (minHeap->size) {
         MinHeapNode* minNode = extractMin(minHeap);
         int u = minNode->vertex;
+        free(minNode);
 
         ListNode* temp = graph->adjList[u];
         while (temp != NULL) {
@@ -182,12 +269,39 @@ int dijkstra(Graph* graph, int src, int target, int parent[]) {
     }
 
     free(minHeap);
+}
 
+// Dijkstra's Algorithm to find the shortest path between two nodes, storing the path
+int dijkstra(Graph* graph, int src, int target, int parent[]) {
+    int dist[MAX_NODES];
+    dijkstraAll(graph, src, dist, parent);
     return dist[target];
 }
 
+// Word-at-a-time FNV-1a style checksum, cheaper than hashing byte by byte
+unsigned long long checksumWords(const int* words, size_t count, unsigned long long hash) {
+    for (size_t i = 0; i < count; i++) {
+        hash ^= (unsigned int)words[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
 // Updated getDistance function using Dijkstra's algorithm with path tracking
 int getDistance(Graph* graph, int u, int v, int parent[]) {
+    if (!isReachable(graph, u, v)) {
+        for (int i = 0; i < graph->numNodes; i++) {
+            parent[i] = -1;
+        }
+        return INF;  // Different components, skip the search entirely
+    }
+
+    // Answer from the precomputed tables when they are available
+    if (routing.dist != NULL && routing.numNodes == graph->numNodes) {
+        memcpy(parent, routing.pred + (size_t)u * routing.numNodes, routing.numNodes * sizeof(int));
+        return routing.dist[(size_t)u * routing.numNodes + v];
+    }
+
     int distance = dijkstra(graph, u, v, parent);
     if (distance == INF) {
         return INF;  // No path exists between the nodes
@@ -195,6 +309,455 @@ int getDistance(Graph* graph, int u, int v, int parent[]) {
     return distance;
 }
 
+// Relax one tile: c[i][j] = min(c[i][j], a[i][k] + b[k][j]) for every k in the tile.
+// k is the outer loop so the tiles may alias, as they do on the diagonal.
+void minPlusTile(int* c, const int* a, const int* b, int stride) {
+    for (int k = 0; k < MINPLUS_BLOCK; k++) {
+        const int* bk = b + k * stride;
+        for (int i = 0; i < MINPLUS_BLOCK; i++) {
+            int aik = a[i * stride + k];
+            if (aik >= INF) {
+                continue;  // No path through k, nothing can improve
+            }
+            int* ci = c + i * stride;
+#ifdef __AVX2__
+            __m256i va = _mm256_set1_epi32(aik);
+            for (int j = 0; j < MINPLUS_BLOCK; j += 8) {
+                __m256i sum = _mm256_add_epi32(va, _mm256_loadu_si256((const __m256i*)(bk + j)));
+                __m256i cur = _mm256_loadu_si256((const __m256i*)(ci + j));
+                _mm256_storeu_si256((__m256i*)(ci + j), _mm256_min_epi32(cur, sum));
+            }
+#else
+            for (int j = 0; j < MINPLUS_BLOCK; j++) {
+                int sum = aik + bk[j];
+                if (sum < ci[j]) {
+                    ci[j] = sum;
+                }
+            }
+#endif
+        }
+    }
+}
+
+// Same relaxation for a tile that aliases neither input, so each row of c can stay
+// in registers while every k is applied to it.
+void minPlusTileDisjoint(int* c, const int* a, const int* b, int stride) {
+    for (int i = 0; i < MINPLUS_BLOCK; i++) {
+        int* ci = c + i * stride;
+        const int* ai = a + i * stride;
+#ifdef __AVX2__
+        __m256i row[MINPLUS_BLOCK / 8];
+        for (int v = 0; v < MINPLUS_BLOCK / 8; v++) {
+            row[v] = _mm256_loadu_si256((const __m256i*)(ci + v * 8));
+        }
+        for (int k = 0; k < MINPLUS_BLOCK; k++) {
+            if (ai[k] >= INF) {
+                continue;
+            }
+            __m256i va = _mm256_set1_epi32(ai[k]);
+            const int* bk = b + k * stride;
+            for (int v = 0; v < MINPLUS_BLOCK / 8; v++) {
+                __m256i sum = _mm256_add_epi32(va, _mm256_loadu_si256((const __m256i*)(bk + v * 8)));
+                row[v] = _mm256_min_epi32(row[v], sum);
+            }
+        }
+        for (int v = 0; v < MINPLUS_BLOCK / 8; v++) {
+            _mm256_storeu_si256((__m256i*)(ci + v * 8), row[v]);
+        }
+#else
+        for (int k = 0; k < MINPLUS_BLOCK; k++) {
+            if (ai[k] >= INF) {
+                continue;
+            }
+            const int* bk = b + k * stride;
+            for (int j = 0; j < MINPLUS_BLOCK; j++) {
+                int sum = ai[k] + bk[j];
+                if (sum < ci[j]) {
+                    ci[j] = sum;
+                }
+            }
+        }
+#endif
+    }
+}
+
+// Blocked Floyd-Warshall over a stride x stride matrix (stride a multiple of MINPLUS_BLOCK).
+// Entries must start at most INF with a zero diagonal; INF + INF still fits in an int.
+void minPlusClosure(int* dist, int stride) {
+    int blocks = stride / MINPLUS_BLOCK;
+
+    for (int kb = 0; kb < blocks; kb++) {
+        int* diag = dist + (kb * stride + kb) * MINPLUS_BLOCK;
+
+        // Phase 1: the diagonal tile depends only on itself
+        minPlusTile(diag, diag, diag, stride);
+
+        // Phase 2: tiles sharing a row or column with the diagonal tile
+        for (int b = 0; b < blocks; b++) {
+            if (b == kb) {
+                continue;
+            }
+            int* rowTile = dist + (kb * stride + b) * MINPLUS_BLOCK;
+            int* colTile = dist + (b * stride + kb) * MINPLUS_BLOCK;
+            minPlusTile(rowTile, diag, rowTile, stride);
+            minPlusTile(colTile, colTile, diag, stride);
+        }
+
+        // Phase 3: every remaining tile, using the finished row and column tiles
+        for (int ib = 0; ib < blocks; ib++) {
+            if (ib == kb) {
+                continue;
+            }
+            for (int jb = 0; jb < blocks; jb++) {
+                if (jb == kb) {
+                    continue;
+                }
+                minPlusTileDisjoint(dist + (ib * stride + jb) * MINPLUS_BLOCK,
+                                    dist + (ib * stride + kb) * MINPLUS_BLOCK,
+                                    dist + (kb * stride + jb) * MINPLUS_BLOCK, stride);
+            }
+        }
+    }
+}
+
+// Close the subgraph induced by the given nodes; entry [i * stride + j] is the distance
+// from nodes[i] to nodes[j] using only edges between listed nodes. This matches
+// dijkstra() only when the list is closed under shortest paths, such as a whole
+// connected component; use buildDistanceMatrix() for arbitrary stops. Returns NULL if
+// a node is out of range or listed twice. The caller frees the returned matrix.
+int* buildInducedDistanceMatrix(Graph* graph, int* nodes, int n, int* strideOut) {
+    int stride = (n + MINPLUS_BLOCK - 1) / MINPLUS_BLOCK * MINPLUS_BLOCK;
+    int* dist = (int*)malloc((size_t)stride * stride * sizeof(int));
+    int* index = (int*)malloc(graph->numNodes * sizeof(int));
+    if (dist == NULL || index == NULL) {
+        free(dist);
+        free(index);
+        return NULL;
+    }
+
+    for (int i = 0; i < graph->numNodes; i++) {
+        index[i] = -1;
+    }
+    for (int i = 0; i < n; i++) {
+        if (nodes[i] < 0 || nodes[i] >= graph->numNodes || index[nodes[i]] != -1) {
+            free(dist);
+            free(index);
+            return NULL;
+        }
+        index[nodes[i]] = i;
+    }
+
+    // Padding rows and columns stay isolated so they never shorten a real path
+    for (int i = 0; i < stride; i++) {
+        for (int j = 0; j < stride; j++) {
+            dist[i * stride + j] = (i == j) ? 0 : INF;
+        }
+    }
+
+    for (int i = 0; i < n; i++) {
+        ListNode* temp = graph->adjList[nodes[i]];
+        while (temp != NULL) {
+            int j = index[temp->vertex];
+            if (j != -1 && temp->weight < dist[i * stride + j]) {
+                dist[i * stride + j] = temp->weight;
+            }
+            temp = temp->next;
+        }
+    }
+
+    free(index);
+    minPlusClosure(dist, stride);
+    *strideOut = stride;
+    return dist;
+}
+
+// Build a dense shortest-path table between arbitrary stops, e.g. for tour improvement;
+// entry [i * stride + j] is the distance from nodes[i] to nodes[j], INF if unreachable.
+// Each connected component holding a stop is closed as a whole, so paths may pass
+// through nodes that are not stops. Needs labelComponents(); returns NULL if a node is
+// out of range or listed twice. The caller frees the returned matrix.
+int* buildDistanceMatrix(Graph* graph, int* nodes, int n, int* strideOut) {
+    int total = graph->numNodes;
+    int* dist = (int*)malloc((size_t)n * n * sizeof(int));
+    int* isStop = (int*)calloc(total, sizeof(int));
+    int* closed = (int*)calloc(total, sizeof(int));  // Components already handled
+    int* region = (int*)malloc(total * sizeof(int));
+    int* regionIndex = (int*)malloc(total * sizeof(int));
+    int ok = dist != NULL && isStop != NULL && closed != NULL && region != NULL && regionIndex != NULL;
+
+    for (int i = 0; ok && i < n; i++) {
+        if (nodes[i] < 0 || nodes[i] >= total || isStop[nodes[i]]) {
+            ok = 0;
+        } else {
+            isStop[nodes[i]] = 1;
+        }
+    }
+
+    for (int i = 0; ok && i < n * n; i++) {
+        dist[i] = (i / n == i % n) ? 0 : INF;
+    }
+
+    for (int i = 0; ok && i < n; i++) {
+        int label = graph->component[nodes[i]];
+        if (closed[label]) {
+            continue;
+        }
+        closed[label] = 1;
+
+        int size = 0;
+        for (int v = 0; v < total; v++) {
+            if (graph->component[v] == label) {
+                regionIndex[v] = size;
+                region[size++] = v;
+            }
+        }
+
+        int regionStride;
+        int* closure = buildInducedDistanceMatrix(graph, region, size, &regionStride);
+        if (closure == NULL) {
+            ok = 0;
+            break;
+        }
+
+        // Copy out the rows and columns of the stops in this component
+        for (int a = i; a < n; a++) {
+            if (graph->component[nodes[a]] != label) {
+                continue;
+            }
+            const int* row = closure + (size_t)regionIndex[nodes[a]] * regionStride;
+            for (int b = 0; b < n; b++) {
+                if (graph->component[nodes[b]] == label) {
+                    dist[a * n + b] = row[regionIndex[nodes[b]]];
+                }
+            }
+        }
+        free(closure);
+    }
+
+    free(isStop);
+    free(closed);
+    free(region);
+    free(regionIndex);
+    if (!ok) {
+        free(dist);
+        return NULL;
+    }
+    *strideOut = n;
+    return dist;
+}
+
+// FNV-1a hash, used for the graph fingerprint
+unsigned long long fnv1a(const void* data, size_t len, unsigned long long hash) {
+    const unsigned char* bytes = (const unsigned char*)data;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+// Fingerprint of the graph so a snapshot built from a different map is refused
+unsigned long long graphFingerprint(Graph* graph) {
+    unsigned long long hash = fnv1a(&graph->numNodes, sizeof(int), FNV_OFFSET);
+    for (int u = 0; u < graph->numNodes; u++) {
+        hash = fnv1a(&u, sizeof(int), hash);
+        ListNode* temp = graph->adjList[u];
+        while (temp != NULL) {
+            hash = fnv1a(&temp->vertex, sizeof(int), hash);
+            hash = fnv1a(&temp->weight, sizeof(int), hash);
+            temp = temp->next;
+        }
+    }
+    return hash;
+}
+
+// Build all-pairs distance and predecessor tables with one Dijkstra run per source, so
+// equal-length paths are broken exactly as an on-demand search breaks them.
+// Returns a single allocation holding dist followed by pred, or NULL on failure.
+int* buildRoutingTables(Graph* graph) {
+    int n = graph->numNodes;
+    int* tables = (int*)malloc((size_t)2 * n * n * sizeof(int));
+    if (tables == NULL) {
+        return NULL;
+    }
+
+    for (int s = 0; s < n; s++) {
+        dijkstraAll(graph, s, tables + (size_t)s * n, tables + (size_t)n * n + (size_t)s * n);
+    }
+    return tables;
+}
+
+// Write the routing tables to a snapshot file; returns 1 on success
+int saveSnapshot(const char* path, Graph* graph, const int* tables) {
+    SnapshotHeader header;
+    int n = graph->numNodes;
+    size_t tableWords = (size_t)2 * n * n;
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header.version = SNAPSHOT_VERSION;
+    header.byteOrder = SNAPSHOT_BYTE_ORDER;
+    header.intSize = sizeof(int);
+    header.numNodes = n;
+    header.graphHash = graphFingerprint(graph);
+    header.payloadSize = tableWords * sizeof(int);
+    header.payloadChecksum = checksumWords(tables, tableWords, FNV_OFFSET);
+
+    // Write to a temporary file first so a crash never leaves a torn snapshot behind;
+    // the process id keeps two instances from writing the same temporary file
+    char tmpPath[1024];
+    if (snprintf(tmpPath, sizeof(tmpPath), "%s.%ld.tmp", path, (long)getpid()) >= (int)sizeof(tmpPath)) {
+        return 0;
+    }
+    FILE* file = fopen(tmpPath, "wb");
+    if (file == NULL) {
+        return 0;
+    }
+    int ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+             fwrite(tables, tableWords * sizeof(int), 1, file) == 1;
+    ok = (fclose(file) == 0) && ok;
+    if (!ok) {
+        remove(tmpPath);
+        return 0;
+    }
+#ifdef _WIN32
+    remove(path);  // rename() does not replace an existing file on Windows
+#endif
+    if (rename(tmpPath, path) != 0) {
+        remove(tmpPath);
+        return 0;
+    }
+    return 1;
+}
+
+// Map a snapshot file and point the routing tables at it; returns 1 on success.
+// Snapshots from a machine with another byte order or int size, with a different
+// version, node count or graph, or whose tables fail the checksum are refused.
+int loadSnapshot(const char* path, Graph* graph) {
+    const unsigned char* data;
+    size_t size;
+
+#ifndef _WIN32
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return 0;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(SnapshotHeader)) {
+        close(fd);
+        return 0;
+    }
+    size = (size_t)st.st_size;
+    void* mapped = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        return 0;
+    }
+    data = (const unsigned char*)mapped;
+#else
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        return 0;
+    }
+    long length = -1;
+    if (fseek(file, 0, SEEK_END) == 0) {
+        length = ftell(file);
+    }
+    if (length < (long)sizeof(SnapshotHeader) || fseek(file, 0, SEEK_SET) != 0) {
+        fclose(file);
+        return 0;
+    }
+    size = (size_t)length;
+    unsigned char* buffer = (unsigned char*)malloc(size);
+    if (buffer == NULL || fread(buffer, size, 1, file) != 1) {
+        free(buffer);
+        fclose(file);
+        return 0;
+    }
+    fclose(file);
+    data = buffer;
+#endif
+
+    const SnapshotHeader* header = (const SnapshotHeader*)data;
+    int n = graph->numNodes;
+    size_t tableWords = (size_t)2 * n * n;
+    size_t payloadSize = tableWords * sizeof(int);
+    const char* reason = NULL;
+
+    if (memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0) {
+        reason = "not a routing snapshot";
+    } else if (header->byteOrder != SNAPSHOT_BYTE_ORDER || header->intSize != sizeof(int)) {
+        reason = "written on a machine with a different byte order or int size";
+    } else if (header->version != SNAPSHOT_VERSION) {
+        reason = "unsupported version";
+    } else if (header->numNodes != (unsigned int)graph->numNodes ||
+               header->graphHash != graphFingerprint(graph)) {
+        reason = "built from a different map";
+    } else if (header->payloadSize != payloadSize || size != sizeof(SnapshotHeader) + payloadSize) {
+        reason = "truncated file";
+    } else if (header->payloadChecksum !=
+               checksumWords((const int*)(data + sizeof(SnapshotHeader)), tableWords, FNV_OFFSET)) {
+        reason = "checksum mismatch";
+    }
+
+    if (reason != NULL) {
+        printf("Ignoring routing snapshot %s: %s.\n", path, reason);
+#ifndef _WIN32
+        munmap((void*)data, size);
+#else
+        free((void*)data);
+#endif
+        return 0;
+    }
+
+    const int* tables = (const int*)(data + sizeof(SnapshotHeader));
+    routing.numNodes = n;
+    routing.dist = tables;
+    routing.pred = tables + (size_t)n * n;
+    return 1;
+}
+
+// Pick the snapshot path: $ROUTING_SNAPSHOT when set, otherwise SNAPSHOT_FILE in the
+// directory of the executable. Returns 0 when snapshots are disabled or the path is too long.
+int snapshotPath(const char* program, char* path, size_t size) {
+    const char* configured = getenv(SNAPSHOT_ENV);
+    if (configured != NULL) {
+        return configured[0] != '\0' && snprintf(path, size, "%s", configured) < (int)size;
+    }
+
+    const char* slash = strrchr(program, '/');
+#ifdef _WIN32
+    const char* backslash = strrchr(program, '\\');
+    if (backslash != NULL && (slash == NULL || backslash > slash)) {
+        slash = backslash;
+    }
+#endif
+    int dirLength = (slash == NULL) ? 0 : (int)(slash - program + 1);
+    return snprintf(path, size, "%.*s%s", dirLength, program, SNAPSHOT_FILE) < (int)size;
+}
+
+// Load the routing tables from the snapshot, rebuilding and saving them if it is unusable.
+// A NULL path builds the tables in memory only.
+void warmStartRouting(Graph* graph, const char* path) {
+    if (path != NULL && loadSnapshot(path, graph)) {
+        printf("Loaded routing snapshot %s.\n", path);
+        return;
+    }
+
+    int* tables = buildRoutingTables(graph);
+    if (tables == NULL) {
+        printf("Could not build routing tables, falling back to Dijkstra.\n");
+        return;
+    }
+    routing.numNodes = graph->numNodes;
+    routing.dist = tables;
+    routing.pred = tables + (size_t)graph->numNodes * graph->numNodes;
+
+    if (path != NULL && !saveSnapshot(path, graph, tables)) {
+        printf("Could not write routing snapshot %s.\n", path);
+    }
+}
+
 // Nearest Neighbor Heuristic for TSP, showing all nodes in the path
 void nearestNeighborTSP(Graph* graph, int startNode, int* orderNodes, int n) {
     int visited[MAX_NODES] = {0};  // Track visited nodes
@@ -202,9 +765,18 @@ void nearestNeighborTSP(Graph* graph, int startNode, int* orderNodes, int n) {
     int totalDistance = 0;
     int currentNode = startNode;
 
+    visited[startNode] = 1;
+
+    // Separate out stops that cannot be reached so they don't corrupt the total
+    for (int j = 0; j < n; j++) {
+        if (!visited[orderNodes[j]] && !isReachable(graph, startNode, orderNodes[j])) {
+            printf("Skipping unreachable stop: Node %d\n", orderNodes[j]);
+            visited[orderNodes[j]] = 1;
+        }
+    }
+
     printf("Starting from warehouse (Node %d)\n", startNode);
     printf("Optimal Route: %d ", startNode);
-    visited[startNode] = 1;
 
     for (int i = 0; i < n; i++) {
         int nextNode = -1;
@@ -280,7 +852,17 @@ void displayInventory() {
 }
 
 // Process an order and set the delivery location (customer)
-void processOrder(char productName[], int quantity, int location) {
+void processOrder(Graph* graph, char productName[], int quantity, int location) {
+    if (location < 0 || location >= graph->numNodes) {
+        printf("Invalid customer location %d.\n", location);
+        return;
+    }
+    if (!isReachable(graph, WAREHOUSE_NODE, location)) {
+        printf("Customer location %d cannot be reached from the warehouse (Node %d). Order rejected.\n",
+               location, WAREHOUSE_NODE);
+        return;
+    }
+
     for (int i = 0; i < productCount; i++) {
         if (strcmp(inventory[i].name, productName) == 0) {
             if (inventory[i].quantity >= quantity) {
@@ -303,10 +885,10 @@ void processOrder(char productName[], int quantity, int location) {
     printf("Product %s not found in inventory.\n", productName);
 }
 
-int main() {
-    // Initialize graph with 50 nodes
+int main(int argc, char* argv[]) {
+    // Initialize graph with the map's nodes
     Graph graph;
-    graph.numNodes = MAX_NODES;
+    graph.numNodes = MAP_NODES;
     for (int i = 0; i < MAX_NODES; i++) {
         graph.adjList[i] = NULL;
     }
@@ -657,6 +1239,13 @@ int main() {
     addEdge(&graph, 286, 287, 60);     // 352
     addEdge(&graph, 287, 259, 120);     //   353
 
+    // Label connected components so unreachable deliveries are rejected up front
+    labelComponents(&graph);
+
+    // Reuse the precomputed routing tables from the last run when they still match the map
+    char snapshot[1024];
+    int useSnapshot = snapshotPath(argc > 0 ? argv[0] : "", snapshot, sizeof(snapshot));
+    warmStartRouting(&graph, useSnapshot ? snapshot : NULL);
 
     // Add products to the inventory
     int numProducts;
@@ -684,7 +1273,7 @@ int main() {
         scanf("%d", &location);
 
         // Process the order
-        processOrder(productName, quantity, location);
+        processOrder(&graph, productName, quantity, location);
 
         printf("\nDo you want to add another order? (y/n): ");
         scanf(" %c", &choice);
@@ -699,7 +1288,7 @@ int main() {
     } else {
         // Print the optimized delivery route
         printf("\nFinding optimized delivery route...\n");
-        nearestNeighborTSP(&graph, 0, orders, orderCount);
+        nearestNeighborTSP(&graph, WAREHOUSE_NODE, orders, orderCount);
     }
 
     return 0;
@@ -0,0 +1,167 @@
+// Check and benchmark for the blocked min-plus kernel in "final code.c".
+// First checks buildDistanceMatrix() on scattered stops, then times the kernel.
+// Build once with AVX2 and once without to compare the two kernels:
+//   gcc -O2 -mavx2 -o minplus_bench minplus_bench.c
+//   gcc -O2 -o minplus_bench_scalar minplus_bench.c
+// Run with the node counts to test, e.g. ./minplus_bench 1000 2000 4000 8000
+#include <time.h>
+
+#define MAX_NODES 8192
+#define main supplyChainMain
+#include "final code.c"
+#undef main
+
+#define CHECK_SOURCES 3
+#define CHECK_TARGETS 10
+#define SUBSET_NODES 1500
+#define SUBSET_PARTS 3
+#define SUBSET_STOPS 100
+#define SUBSET_PAIRS 300
+
+Graph graph;
+
+// Build a random graph of `parts` components, node v belonging to component v % parts:
+// a random spanning tree of each component plus 2n extra edges inside components
+void buildRandomGraph(int n, int parts) {
+    for (int i = 0; i < MAX_NODES; i++) {
+        ListNode* temp = graph.adjList[i];
+        while (temp != NULL) {
+            ListNode* next = temp->next;
+            free(temp);
+            temp = next;
+        }
+        graph.adjList[i] = NULL;
+    }
+
+    graph.numNodes = n;
+    for (int i = parts; i < n; i++) {
+        addEdge(&graph, i, i % parts + parts * (rand() % (i / parts)), 1 + rand() % 20);
+    }
+    for (int e = 0; e < 2 * n; e++) {
+        int u = rand() % n;
+        int count = (n - u % parts + parts - 1) / parts;  // Nodes in u's component
+        int v = u % parts + parts * (rand() % count);
+        addEdge(&graph, u, v, 1 + rand() % 20);
+    }
+}
+
+// Check buildDistanceMatrix() on scattered stops spread over several components;
+// returns the number of failures
+int checkSubset(void) {
+    static int order[SUBSET_NODES];
+    static int parent[MAX_NODES];
+    int stops[SUBSET_STOPS];
+
+    buildRandomGraph(SUBSET_NODES, SUBSET_PARTS);
+    labelComponents(&graph);
+
+    // Pick distinct stops with a partial shuffle
+    for (int i = 0; i < SUBSET_NODES; i++) {
+        order[i] = i;
+    }
+    for (int i = 0; i < SUBSET_STOPS; i++) {
+        int j = i + rand() % (SUBSET_NODES - i);
+        int temp = order[i];
+        order[i] = order[j];
+        order[j] = temp;
+        stops[i] = order[i];
+    }
+
+    int stride;
+    int* dist = buildDistanceMatrix(&graph, stops, SUBSET_STOPS, &stride);
+    if (dist == NULL) {
+        printf("Subset: could not build the distance matrix\n");
+        return 1;
+    }
+
+    int mismatches = 0, unreachable = 0;
+    for (int p = 0; p < SUBSET_PAIRS; p++) {
+        int a = rand() % SUBSET_STOPS;
+        int b = rand() % SUBSET_STOPS;
+        int expected = dijkstra(&graph, stops[a], stops[b], parent);
+        if (expected != dist[a * stride + b]) {
+            mismatches++;
+        }
+        if (expected == INF) {
+            unreachable++;
+        }
+    }
+    free(dist);
+
+    printf("Subset: %d stops over %d components, %d of %d sampled pairs differ from dijkstra() (%d unreachable)\n",
+           SUBSET_STOPS, SUBSET_PARTS, mismatches, SUBSET_PAIRS, unreachable);
+
+    // Duplicate and out-of-range stops must be refused
+    int refused = 0;
+    stops[1] = stops[0];
+    dist = buildDistanceMatrix(&graph, stops, SUBSET_STOPS, &stride);
+    refused += dist == NULL;
+    free(dist);
+    stops[1] = SUBSET_NODES;
+    dist = buildDistanceMatrix(&graph, stops, SUBSET_STOPS, &stride);
+    refused += dist == NULL;
+    free(dist);
+    if (refused != 2) {
+        printf("Subset: duplicate or out-of-range stops were not refused\n");
+    }
+
+    return mismatches + (2 - refused);
+}
+
+int main(int argc, char* argv[]) {
+    static int nodes[MAX_NODES];
+    static int parent[MAX_NODES];
+    int defaultSizes[] = {1000, 2000, 4000, 8000};
+    int sizeCount = argc > 1 ? argc - 1 : 4;
+    int failures = 0;
+
+#ifdef __AVX2__
+    printf("Kernel: AVX2\n");
+#else
+    printf("Kernel: scalar\n");
+#endif
+
+    srand(7);
+    failures += checkSubset();
+
+    for (int s = 0; s < sizeCount; s++) {
+        int n = argc > 1 ? atoi(argv[s + 1]) : defaultSizes[s];
+        if (n < 1 || n > MAX_NODES) {
+            printf("Skipping size %d, must be between 1 and %d\n", n, MAX_NODES);
+            continue;
+        }
+
+        buildRandomGraph(n, 1);
+        for (int i = 0; i < n; i++) {
+            nodes[i] = i;
+        }
+
+        int stride;
+        clock_t start = clock();
+        int* dist = buildInducedDistanceMatrix(&graph, nodes, n, &stride);
+        double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+        if (dist == NULL) {
+            printf("n=%d: could not build the distance matrix\n", n);
+            return 1;
+        }
+
+        // Compare sampled pairs against dijkstra()
+        int mismatches = 0;
+        for (int q = 0; q < CHECK_SOURCES; q++) {
+            int src = rand() % n;
+            for (int t = 0; t < CHECK_TARGETS; t++) {
+                int target = rand() % n;
+                if (dijkstra(&graph, src, target, parent) != dist[src * stride + target]) {
+                    mismatches++;
+                }
+            }
+        }
+
+        printf("n=%d: %.3fs, %d of %d sampled pairs differ from dijkstra()\n",
+               n, seconds, mismatches, CHECK_SOURCES * CHECK_TARGETS);
+        failures += mismatches;
+        free(dist);
+    }
+
+    return failures != 0;
+}